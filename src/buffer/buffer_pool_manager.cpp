@@ -15,14 +15,36 @@
 #include <list>
 #include <unordered_map>
 
+#ifdef __linux__
+#include <sys/mman.h>
+
+#include <cstdint>
+#endif
+
 namespace bustub {
 
 BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, LogManager *log_manager)
     : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
   // We allocate a consecutive memory space for the buffer pool.
   pages_ = new Page[pool_size_];
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Index descents touch frames at random strides, so with 4KB mappings a
+  // large pool burns a DTLB entry per frame touched. Ask the kernel to back
+  // the arena with transparent hugepages, which cover it with ~512x fewer
+  // entries. Purely advisory: the range is widened to the surrounding OS
+  // page boundaries as madvise requires, and if THP is unavailable the call
+  // fails and the pool simply runs on normal pages.
+  constexpr uintptr_t kOsPageSize = 4096;
+  auto begin = reinterpret_cast<uintptr_t>(pages_) & ~(kOsPageSize - 1);
+  auto end = (reinterpret_cast<uintptr_t>(pages_ + pool_size_) + kOsPageSize - 1) & ~(kOsPageSize - 1);
+  madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#endif
   replacer_ = new LRUReplacer(pool_size);
 
+  // The page table is probed once per B+ tree level on every descent; size it
+  // for the full pool up front so those lookups never rehash and rarely chain.
+  page_table_.reserve(pool_size_);
+
   // Initially, every page is in the free list.
   for (size_t i = 0; i < pool_size_; ++i) {
     free_list_.emplace_back(static_cast<int>(i));
@@ -42,14 +64,56 @@ Page *BufferPoolManager::FetchPageImpl(page_id_t page_id) {
   // 2.     If R is dirty, write it back to the disk.
   // 3.     Delete R from the page table and insert P.
   // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
-  return nullptr;
+  std::lock_guard<std::mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    Page *page = &pages_[it->second];
+    page->pin_count_++;
+    replacer_->Pin(it->second);
+    return page;
+  }
+  frame_id_t frame_id;
+  if (!FindVictimFrame(&frame_id)) {
+    return nullptr;
+  }
+  Page *page = &pages_[frame_id];
+  page_table_[page_id] = frame_id;
+  page->page_id_ = page_id;
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  disk_manager_->ReadPage(page_id, page->data_);
+  replacer_->Pin(frame_id);
+  return page;
 }
 
-bool BufferPoolManager::UnpinPageImpl(page_id_t page_id, bool is_dirty) { return false; }
+bool BufferPoolManager::UnpinPageImpl(page_id_t page_id, bool is_dirty) {
+  std::lock_guard<std::mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return false;
+  }
+  Page *page = &pages_[it->second];
+  if (page->pin_count_ <= 0) {
+    return false;
+  }
+  page->is_dirty_ = page->is_dirty_ || is_dirty;
+  if (--page->pin_count_ == 0) {
+    replacer_->Unpin(it->second);
+  }
+  return true;
+}
 
 bool BufferPoolManager::FlushPageImpl(page_id_t page_id) {
   // Make sure you call DiskManager::WritePage!
-  return false;
+  std::lock_guard<std::mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return false;
+  }
+  Page *page = &pages_[it->second];
+  disk_manager_->WritePage(page_id, page->data_);
+  page->is_dirty_ = false;
+  return true;
 }
 
 Page *BufferPoolManager::NewPageImpl(page_id_t *page_id) {
@@ -58,7 +122,21 @@ Page *BufferPoolManager::NewPageImpl(page_id_t *page_id) {
   // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
   // 3.   Update P's metadata, zero out memory and add P to the page table.
   // 4.   Set the page ID output parameter. Return a pointer to P.
-  return nullptr;
+  std::lock_guard<std::mutex> guard(latch_);
+  frame_id_t frame_id;
+  if (!FindVictimFrame(&frame_id)) {
+    return nullptr;
+  }
+  page_id_t new_page_id = disk_manager_->AllocatePage();
+  Page *page = &pages_[frame_id];
+  page_table_[new_page_id] = frame_id;
+  page->page_id_ = new_page_id;
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  page->ResetMemory();
+  replacer_->Pin(frame_id);
+  *page_id = new_page_id;
+  return page;
 }
 
 bool BufferPoolManager::DeletePageImpl(page_id_t page_id) {
@@ -67,11 +145,81 @@ bool BufferPoolManager::DeletePageImpl(page_id_t page_id) {
   // 1.   If P does not exist, return true.
   // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
   // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-  return false;
+  std::lock_guard<std::mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    disk_manager_->DeallocatePage(page_id);
+    return true;
+  }
+  Page *page = &pages_[it->second];
+  if (page->pin_count_ > 0) {
+    return false;
+  }
+  disk_manager_->DeallocatePage(page_id);
+  replacer_->Pin(it->second);
+  free_list_.push_back(it->second);
+  page_table_.erase(it);
+  page->page_id_ = INVALID_PAGE_ID;
+  page->pin_count_ = 0;
+  page->is_dirty_ = false;
+  page->ResetMemory();
+  return true;
 }
 
 void BufferPoolManager::FlushAllPagesImpl() {
-  // You can do it!
+  std::lock_guard<std::mutex> guard(latch_);
+  for (const auto &entry : page_table_) {
+    Page *page = &pages_[entry.second];
+    disk_manager_->WritePage(page->page_id_, page->data_);
+    page->is_dirty_ = false;
+  }
+}
+
+Page *BufferPoolManager::NewPageWithId(page_id_t page_id) {
+  std::lock_guard<std::mutex> guard(latch_);
+  frame_id_t frame_id;
+  if (!FindVictimFrame(&frame_id)) {
+    return nullptr;
+  }
+  Page *page = &pages_[frame_id];
+  page_table_[page_id] = frame_id;
+  page->page_id_ = page_id;
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  page->ResetMemory();
+  replacer_->Pin(frame_id);
+  return page;
+}
+
+void BufferPoolManager::PrefetchPage(page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return;
+  }
+  const char *data = pages_[it->second].GetData();
+  __builtin_prefetch(data);
+  __builtin_prefetch(data + 64);
+}
+
+bool BufferPoolManager::FindVictimFrame(frame_id_t *frame_id) {
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+  }
+  if (!replacer_->Victim(frame_id)) {
+    return false;
+  }
+  Page *victim = &pages_[*frame_id];
+  if (victim->is_dirty_) {
+    disk_manager_->WritePage(victim->page_id_, victim->data_);
+  }
+  page_table_.erase(victim->page_id_);
+  return true;
 }
 
 }  // namespace bustub
@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_manager_set.cpp
+//
+// Identification: src/buffer/buffer_pool_manager_set.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/buffer_pool_manager_set.h"
+
+namespace bustub {
+
+BufferPoolManagerSet::BufferPoolManagerSet(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                                           LogManager *log_manager)
+    : pool_size_(pool_size), disk_manager_(disk_manager) {
+  instances_.reserve(num_instances);
+  for (size_t i = 0; i < num_instances; ++i) {
+    instances_.push_back(new BufferPoolManager(pool_size, disk_manager, log_manager));
+  }
+}
+
+BufferPoolManagerSet::~BufferPoolManagerSet() {
+  for (BufferPoolManager *instance : instances_) {
+    delete instance;
+  }
+}
+
+Page *BufferPoolManagerSet::NewPage(page_id_t *page_id) {
+  // The id decides the owning instance, so it has to be allocated before the
+  // page can be placed; hand it back if that instance has no frame to spare.
+  *page_id = disk_manager_->AllocatePage();
+  Page *page = Instance(*page_id)->NewPageWithId(*page_id);
+  if (page == nullptr) {
+    disk_manager_->DeallocatePage(*page_id);
+  }
+  return page;
+}
+
+void BufferPoolManagerSet::FlushAllPages() {
+  for (BufferPoolManager *instance : instances_) {
+    instance->FlushAllPages();
+  }
+}
+
+}  // namespace bustub
@@ -91,6 +91,26 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
+  /**
+   * Materializes an already-allocated page id in this buffer pool, pinned
+   * and zeroed like a NewPage result. Used by BufferPoolManagerSet, which
+   * allocates page ids centrally and routes each page to the instance that
+   * owns its hash.
+   * @param page_id id of the page to materialize
+   * @return nullptr if every frame is pinned, otherwise pointer to the page
+   */
+  Page *NewPageWithId(page_id_t page_id);
+
+  /**
+   * Hint that a page is about to be accessed. If the page is resident its
+   * frame's leading cache lines are prefetched so the upcoming FetchPage
+   * touches warm memory; non-resident pages are ignored, since this manager
+   * has no asynchronous I/O path that could overlap the disk read.
+   * Does not pin the page.
+   * @param page_id id of the page about to be accessed
+   */
+  void PrefetchPage(page_id_t page_id);
+
   /** @return pointer to all the pages in the buffer pool */
   Page *GetPages() { return pages_; }
 
@@ -152,6 +172,15 @@ class BufferPoolManager {
    */
   void FlushAllPagesImpl();
 
+  /**
+   * Finds a frame to hold a new page, taking it from the free list first and
+   * evicting an unpinned page (writing it back if dirty) otherwise.
+   * Caller must hold latch_.
+   * @param[out] frame_id id of the found frame
+   * @return false if every frame is pinned, true otherwise
+   */
+  bool FindVictimFrame(frame_id_t *frame_id);
+
   /** Number of pages in the buffer pool. */
   size_t pool_size_;
   /** Array of buffer pool pages. */
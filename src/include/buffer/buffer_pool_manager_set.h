@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_manager_set.h
+//
+// Identification: src/include/buffer/buffer_pool_manager_set.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+namespace bustub {
+
+/**
+ * BufferPoolManagerSet shards pages across several independent
+ * BufferPoolManager instances by hashing the page id, so concurrent accesses
+ * to unrelated pages contend on different pool latches instead of a single
+ * global one. Page ids are allocated centrally from the shared DiskManager
+ * and every page lives in the instance that owns its hash, which keeps the
+ * routing deterministic across fetch, unpin, flush and delete.
+ */
+class BufferPoolManagerSet {
+ public:
+  /**
+   * Creates a new BufferPoolManagerSet.
+   * @param num_instances number of buffer pool instances to shard across
+   * @param pool_size the size of each buffer pool instance
+   * @param disk_manager the disk manager, shared by all instances
+   * @param log_manager the log manager (for testing only: nullptr = disable logging)
+   */
+  BufferPoolManagerSet(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                       LogManager *log_manager = nullptr);
+
+  /**
+   * Destroys an existing BufferPoolManagerSet.
+   */
+  ~BufferPoolManagerSet();
+
+  /** Fetch the page from the instance owning its hash. */
+  Page *FetchPage(page_id_t page_id) { return Instance(page_id)->FetchPage(page_id); }
+
+  /** Unpin the page in the instance owning its hash. */
+  bool UnpinPage(page_id_t page_id, bool is_dirty) { return Instance(page_id)->UnpinPage(page_id, is_dirty); }
+
+  /** Flush the page from the instance owning its hash. */
+  bool FlushPage(page_id_t page_id) { return Instance(page_id)->FlushPage(page_id); }
+
+  /**
+   * Creates a new page: allocates the id centrally, then materializes the
+   * page in the instance that owns it.
+   * @param[out] page_id id of created page
+   * @return nullptr if the owning instance has no free frame, otherwise pointer to the page
+   */
+  Page *NewPage(page_id_t *page_id);
+
+  /** Delete the page from the instance owning its hash. */
+  bool DeletePage(page_id_t page_id) { return Instance(page_id)->DeletePage(page_id); }
+
+  /** Flushes all pages of every instance to disk. */
+  void FlushAllPages();
+
+  /** Forward the access hint to the instance owning the page's hash. */
+  void PrefetchPage(page_id_t page_id) { Instance(page_id)->PrefetchPage(page_id); }
+
+  /** @return total number of frames across all instances */
+  size_t GetPoolSize() { return instances_.size() * pool_size_; }
+
+ private:
+  /** @return the instance owning the given page id */
+  BufferPoolManager *Instance(page_id_t page_id) {
+    return instances_[static_cast<size_t>(page_id) % instances_.size()];
+  }
+
+  /** Number of frames per instance. */
+  size_t pool_size_;
+  /** Pointer to the disk manager, the central page id allocator. */
+  DiskManager *disk_manager_;
+  /** The buffer pool instances pages are sharded across. */
+  std::vector<BufferPoolManager *> instances_;
+};
+}  // namespace bustub
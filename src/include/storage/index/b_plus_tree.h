@@ -10,6 +10,9 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
+#include <mutex>  // NOLINT
+#include <new>
 #include <queue>
 #include <string>
 #include <vector>
@@ -23,6 +26,65 @@ namespace bustub {
 
 #define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
 
+/**
+ * Key-type-independent part of the B+ tree: root bookkeeping, deferred
+ * header-page maintenance and the latch-crabbing helpers, all of which only
+ * look at the shared BPlusTreePage header. Living outside the template, this
+ * code is compiled and emitted once instead of once per instantiated key
+ * size.
+ */
+class BPlusTreeBase {
+ public:
+  // Returns true if this B+ tree has no keys and values.
+  bool IsEmpty() const;
+
+ protected:
+  BPlusTreeBase(std::string name, BufferPoolManager *buffer_pool_manager, int leaf_max_size, int internal_max_size);
+
+  // What a tree traversal is about to do; determines the latching protocol.
+  enum class Operation { READ, INSERT, DELETE };
+
+  // Typed view of a buffer pool page's payload. A single, laundered cast
+  // point per function keeps the node pointer in a register instead of being
+  // re-derived from Page on every access.
+  template <typename T>
+  static T *AsTreePage(Page *page) {
+    return std::launder(reinterpret_cast<T *>(page->GetData()));
+  }
+
+  void UpdateRootPageId(int insert_record = 0);
+
+  void FlushRootPageId();
+
+  Page *PageInPath(Transaction *transaction, page_id_t page_id) const;
+
+  bool IsSafePage(BPlusTreePage *node, Operation op) const;
+
+  void ReleaseAllLatches(Transaction *transaction, bool dirty);
+
+  // member variable
+  std::string index_name_;
+  // Atomic so read descents can start without taking root_latch_: they load
+  // the id, latch the page, then re-check the id (see
+  // FindLeafPageByOperation). All writes happen under root_latch_.
+  std::atomic<page_id_t> root_page_id_;
+  // Serializes root changes against write descents, which hold it until the
+  // root page (or the first split/merge-safe page) is latched; it is never a
+  // whole-operation serialization point and read descents skip it entirely.
+  std::mutex root_latch_;
+  // root_page_id_ is the authoritative copy; the header page is only written
+  // back by FlushRootPageId() after an operation has dropped its latches, so
+  // the header fetch never sits inside a latched critical section.
+  std::atomic<bool> root_id_dirty_{false};
+  std::atomic<bool> root_id_pending_insert_{false};
+  // Serializes header-page writers; one acquisition flushes all batched
+  // root-id changes.
+  std::mutex header_latch_;
+  BufferPoolManager *buffer_pool_manager_;
+  int leaf_max_size_;
+  int internal_max_size_;
+};
+
 /**
  * Main class providing the API for the Interactive B+ Tree.
  *
@@ -34,7 +96,7 @@ namespace bustub {
  * (4) Implement index iterator for range scan
  */
 INDEX_TEMPLATE_ARGUMENTS
-class BPlusTree {
+class BPlusTree : public BPlusTreeBase {
   using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
   using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
 
@@ -42,9 +104,6 @@ class BPlusTree {
   explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
                      int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE);
 
-  // Returns true if this B+ tree has no keys and values.
-  bool IsEmpty() const;
-
   // Insert a key-value pair into this B+ tree.
   bool Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
 
@@ -60,17 +119,21 @@ class BPlusTree {
   INDEXITERATOR_TYPE end();
 
   void Print(BufferPoolManager *bpm) {
-    ToString(reinterpret_cast<BPlusTreePage *>(bpm->FetchPage(root_page_id_)->GetData()), bpm);
+    ToString(AsTreePage<BPlusTreePage>(bpm->FetchPage(root_page_id_)), bpm);
   }
 
   void Draw(BufferPoolManager *bpm, const std::string &outf) {
     std::ofstream out(outf);
     out << "digraph G {" << std::endl;
-    ToGraph(reinterpret_cast<BPlusTreePage *>(bpm->FetchPage(root_page_id_)->GetData()), bpm, out);
+    ToGraph(AsTreePage<BPlusTreePage>(bpm->FetchPage(root_page_id_)), bpm, out);
     out << "}" << std::endl;
     out.close();
   }
 
+  // Bulk-load entries into an empty tree, building it bottom-up level by
+  // level; degrades to per-key Insert when the tree already holds keys.
+  void BulkLoad(std::vector<MappingType> entries, Transaction *transaction = nullptr);
+
   // read data from file and insert one by one
   void InsertFromFile(const std::string &file_name, Transaction *transaction = nullptr);
 
@@ -84,25 +147,31 @@ class BPlusTree {
 
   bool InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
 
+  // Splits are rare relative to plain inserts; keep their code out of the
+  // hot path's inlined footprint.
   void InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                        Transaction *transaction = nullptr);
+                        Transaction *transaction = nullptr) __attribute__((cold, noinline));
 
   template <typename N>
-  N *Split(N *node);
+  N *Split(N *node) __attribute__((cold, noinline));
 
   template <typename N>
   bool CoalesceOrRedistribute(N *node, Transaction *transaction = nullptr);
 
+  template <typename N>
+  bool ResolveUnderflow(N *node, Transaction *transaction, InternalPage **next_underflow);
+
   template <typename N>
   bool Coalesce(N **neighbor_node, N **node, BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> **parent,
                 int index, Transaction *transaction = nullptr);
 
   template <typename N>
-  void Redistribute(N *neighbor_node, N *node, int index);
+  void Redistribute(N *neighbor_node, N *node, BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> *parent,
+                    int index);
 
   bool AdjustRoot(BPlusTreePage *node);
 
-  void UpdateRootPageId(int insert_record = 0);
+  Page *FindLeafPageByOperation(const KeyType &key, bool left_most, Operation op, Transaction *transaction);
 
   /* Debug Routines for FREE!! */
   void ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstream &out) const;
@@ -110,12 +179,7 @@ class BPlusTree {
   void ToString(BPlusTreePage *page, BufferPoolManager *bpm) const;
 
   // member variable
-  std::string index_name_;
-  page_id_t root_page_id_;
-  BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
-  int leaf_max_size_;
-  int internal_max_size_;
 };
 
 }  // namespace bustub
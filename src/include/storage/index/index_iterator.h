@@ -21,9 +21,13 @@ namespace bustub {
 
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+
  public:
-  // you may define your own constructor based on your member variables
+  // The default-constructed iterator is the O(1) past-the-end sentinel; an
+  // iterator that walks off the last leaf collapses into the same state.
   IndexIterator();
+  IndexIterator(BufferPoolManager *buffer_pool_manager, Page *page, int index);
   ~IndexIterator();
 
   bool isEnd();
@@ -32,12 +36,15 @@ class IndexIterator {
 
   IndexIterator &operator++();
 
-  bool operator==(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator==(const IndexIterator &itr) const { return page_ == itr.page_ && index_ == itr.index_; }
 
-  bool operator!=(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator!=(const IndexIterator &itr) const { return !(*this == itr); }
 
  private:
-  // add your own private member variables here
+  BufferPoolManager *buffer_pool_manager_;
+  /** The pinned leaf page the iterator is positioned on; nullptr at the end. */
+  Page *page_;
+  int index_;
 };
 
 }  // namespace bustub
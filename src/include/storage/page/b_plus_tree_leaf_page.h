@@ -49,7 +49,7 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   page_id_t GetNextPageId() const;
   void SetNextPageId(page_id_t next_page_id);
   KeyType KeyAt(int index) const;
-  int KeyIndex(const KeyType &key, const KeyComparator &comparator) const;
+  int KeyIndex(const KeyType &key, const KeyComparator &comparator) const __attribute__((hot));
   const MappingType &GetItem(int index);
 
   // insert and delete methods
@@ -62,9 +62,10 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void MoveAllTo(BPlusTreeLeafPage *recipient);
   void MoveFirstToEndOf(BPlusTreeLeafPage *recipient);
   void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
+  // also used by the bulk loader to fill fresh leaves wholesale
+  void CopyNFrom(MappingType *items, int size);
 
  private:
-  void CopyNFrom(MappingType *items, int size);
   void CopyLastFrom(const MappingType &item);
   void CopyFirstFrom(const MappingType &item);
   page_id_t next_page_id_;
@@ -42,34 +42,36 @@ enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
  */
 class BPlusTreePage {
  public:
-  bool IsLeafPage() const;
-  bool IsRootPage() const;
+  // Header getters are side-effect free and only read the page header;
+  // [[gnu::pure]] lets the compiler fold repeated calls between writes.
+  bool IsLeafPage() const __attribute__((pure));
+  bool IsRootPage() const __attribute__((pure));
   void SetPageType(IndexPageType page_type);
 
-  int GetSize() const;
+  int GetSize() const __attribute__((pure));
   void SetSize(int size);
   void IncreaseSize(int amount);
 
-  int GetMaxSize() const;
+  int GetMaxSize() const __attribute__((pure));
   void SetMaxSize(int max_size);
-  int GetMinSize() const;
+  int GetMinSize() const __attribute__((pure));
 
-  page_id_t GetParentPageId() const;
+  page_id_t GetParentPageId() const __attribute__((pure));
   void SetParentPageId(page_id_t parent_page_id);
 
-  page_id_t GetPageId() const;
+  page_id_t GetPageId() const __attribute__((pure));
   void SetPageId(page_id_t page_id);
 
   void SetLSN(lsn_t lsn = INVALID_LSN);
 
  private:
   // member variable, attributes that both internal and leaf page share
-  IndexPageType page_type_ __attribute__((__unused__));
+  IndexPageType page_type_;
   lsn_t lsn_ __attribute__((__unused__));
-  int size_ __attribute__((__unused__));
-  int max_size_ __attribute__((__unused__));
-  page_id_t parent_page_id_ __attribute__((__unused__));
-  page_id_t page_id_ __attribute__((__unused__));
+  int size_;
+  int max_size_;
+  page_id_t parent_page_id_;
+  page_id_t page_id_;
 };
 
 }  // namespace bustub
@@ -9,7 +9,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "common/exception.h"
 #include "common/rid.h"
@@ -17,21 +20,25 @@
 #include "storage/page/header_page.h"
 
 namespace bustub {
-INDEX_TEMPLATE_ARGUMENTS
-BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                          int leaf_max_size, int internal_max_size)
+BPlusTreeBase::BPlusTreeBase(std::string name, BufferPoolManager *buffer_pool_manager, int leaf_max_size,
+                             int internal_max_size)
     : index_name_(std::move(name)),
       root_page_id_(INVALID_PAGE_ID),
       buffer_pool_manager_(buffer_pool_manager),
-      comparator_(comparator),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size) {}
 
 /*
  * Helper function to decide whether current b+tree is empty
  */
+bool BPlusTreeBase::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::IsEmpty() const { return true; }
+BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                          int leaf_max_size, int internal_max_size)
+    : BPlusTreeBase(std::move(name), buffer_pool_manager, leaf_max_size, internal_max_size),
+      comparator_(comparator) {}
+
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -42,7 +49,21 @@ bool BPLUSTREE_TYPE::IsEmpty() const { return true; }
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) {
-  return false;
+  Page *leaf_page = FindLeafPageByOperation(key, false, Operation::READ, transaction);
+  if (leaf_page == nullptr) {
+    return false;
+  }
+  auto *leaf = AsTreePage<LeafPage>(leaf_page);
+  ValueType value{};
+  bool found = leaf->Lookup(key, &value, comparator_);
+  // Drop the leaf latch before touching the result vector: push_back may
+  // heap-allocate, and that has no business inside the latched section.
+  leaf_page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+  if (found) {
+    result->push_back(value);
+  }
+  return found;
 }
 
 /*****************************************************************************
@@ -56,7 +77,26 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  * keys return false, otherwise return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) { return false; }
+bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  // The latching protocol tracks the held pages in the transaction's page
+  // set, so callers without a transaction get a scratch one. The scratch is
+  // per-thread and reused across calls: constructing a Transaction heap-
+  // allocates half a dozen shared containers, which is pure overhead to pay
+  // per insert. ReleaseAllLatches() always leaves the sets empty, so reuse
+  // is safe.
+  if (transaction == nullptr) {
+    static thread_local Transaction scratch_txn(INVALID_TXN_ID);
+    transaction = &scratch_txn;
+  }
+  // No empty-tree pre-check here: checking under root_latch_ and then
+  // dropping it before the descent leaves a window where a concurrent
+  // Remove can empty the tree and the insert is silently lost. The descent
+  // itself detects the empty tree while root_latch_ is held and
+  // InsertIntoLeaf starts the new tree under that latch.
+  bool inserted = InsertIntoLeaf(key, value, transaction);
+  FlushRootPageId();
+  return inserted;
+}
 /*
  * Insert constant key & value pair into an empty tree
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
@@ -64,7 +104,19 @@ bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  * tree's root page id and insert entry directly into leaf page.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {}
+void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while starting new tree");
+  }
+  auto *leaf = AsTreePage<LeafPage>(page);
+  leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+  leaf->Insert(key, value, comparator_);
+  root_page_id_ = page_id;
+  UpdateRootPageId(1);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
 
 /*
  * Insert constant key & value pair into leaf page
@@ -76,34 +128,218 @@ void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {}
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction) {
-  return false;
+  Page *leaf_page = FindLeafPageByOperation(key, false, Operation::INSERT, transaction);
+  if (leaf_page == nullptr) {
+    // The tree is (or concurrently became) empty. root_latch_ is still held
+    // through the descent's sentinel, so starting the new tree here cannot
+    // race another root change.
+    StartNewTree(key, value);
+    ReleaseAllLatches(transaction, false);
+    return true;
+  }
+  auto *leaf = AsTreePage<LeafPage>(leaf_page);
+  // Insert performs the duplicate check itself and leaves the page untouched
+  // on a hit, so an unchanged size is the duplicate signal — no separate
+  // Lookup repeating the same comparator-bound binary search. Same pattern
+  // as Remove with RemoveAndDeleteRecord.
+  int old_size = leaf->GetSize();
+  int new_size = leaf->Insert(key, value, comparator_);
+  if (new_size == old_size) {
+    ReleaseAllLatches(transaction, false);
+    return false;
+  }
+  // In a well-filled tree the overwhelming majority of inserts find room, so
+  // the split branch is annotated as the unlikely one; latch release and
+  // unpinning are shared with it through ReleaseAllLatches either way.
+  if (__builtin_expect(new_size >= leaf->GetMaxSize(), 0)) {
+    LeafPage *new_leaf = Split(leaf);
+    InsertIntoParent(leaf, new_leaf->KeyAt(0), new_leaf, transaction);
+  }
+  ReleaseAllLatches(transaction, true);
+  return true;
 }
 
 /*
  * Split input page and return newly created page.
  * Using template N to represent either internal page or leaf page.
- * User needs to first ask for new page from buffer pool manager(NOTICE: throw
- * an "out of memory" exception if returned value is nullptr), then move half
- * of key & value pairs from input page to newly created page
+ * Asks the buffer pool manager for a new page (NOTICE: throws an "out of
+ * memory" exception if that fails) and moves the upper half of the input
+ * page's pairs into it. The new page is returned still pinned; the caller
+ * hands it to InsertIntoParent, which adopts the pin and releases it once
+ * the node is linked in. No parent page is touched here — the parent is
+ * already pinned and write-latched on the crabbed descent path.
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 N *BPLUSTREE_TYPE::Split(N *node) {
-  return nullptr;
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while splitting node");
+  }
+  N *new_node = AsTreePage<N>(page);
+  new_node->Init(page_id, node->GetParentPageId(), node->GetMaxSize());
+  if constexpr (std::is_same_v<N, LeafPage>) {
+    node->MoveHalfTo(new_node);
+  } else {
+    node->MoveHalfTo(new_node, buffer_pool_manager_);
+  }
+  return new_node;
 }
 
 /*
  * Insert key & value pair into internal page after split
  * @param   old_node      input page from split() method
  * @param   key
- * @param   new_node      returned page from split() method
- * User needs to first find the parent page of old_node, parent node must be
- * adjusted to take info of new_node into account. Remember to deal with split
- * recursively if necessary.
+ * @param   new_node      returned page from split() method, still pinned;
+ *                        this method owns that pin and releases it
+ * The parent of old_node is taken from the transaction's crabbed page set
+ * (PageInPath) rather than fetched again — the latching protocol guarantees
+ * every ancestor a split can reach is still pinned and write-latched — so a
+ * split performs no buffer pool calls beyond allocating its new pages.
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                                      Transaction *transaction) {}
+                                      Transaction *transaction) {
+  // Walk the overflow up the tree in a loop rather than recursing: every
+  // parent a split can reach is already write-latched and pinned on the
+  // descent path, so each level is a plain lookup in the transaction page
+  // set instead of a new stack frame plus a buffer pool round trip.
+  KeyType middle_key = key;
+  while (true) {
+    if (old_node->IsRootPage()) {
+      page_id_t page_id;
+      Page *page = buffer_pool_manager_->NewPage(&page_id);
+      if (page == nullptr) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while growing tree height");
+      }
+      auto *new_root = AsTreePage<InternalPage>(page);
+      new_root->Init(page_id, INVALID_PAGE_ID, internal_max_size_);
+      new_root->PopulateNewRoot(old_node->GetPageId(), middle_key, new_node->GetPageId());
+      old_node->SetParentPageId(page_id);
+      new_node->SetParentPageId(page_id);
+      // The root was not a safe page, so the descent still holds root_latch_.
+      root_page_id_ = page_id;
+      UpdateRootPageId(0);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      buffer_pool_manager_->UnpinPage(new_node->GetPageId(), true);
+      return;
+    }
+    Page *parent_page = PageInPath(transaction, old_node->GetParentPageId());
+    auto *parent = AsTreePage<InternalPage>(parent_page);
+    parent->InsertNodeAfter(old_node->GetPageId(), middle_key, new_node->GetPageId());
+    buffer_pool_manager_->UnpinPage(new_node->GetPageId(), true);
+    if (parent->GetSize() < parent->GetMaxSize()) {
+      return;
+    }
+    InternalPage *new_parent = Split(parent);
+    middle_key = new_parent->KeyAt(0);
+    old_node = parent;
+    new_node = new_parent;
+  }
+}
+
+/*
+ * Build a tree bottom-up from the given entries instead of descending once
+ * per key: sort, pack the leaf level sequentially and chain its next
+ * pointers, then build each internal level from the first key of every node
+ * below it. A single pass of sequential page writes replaces a per-key
+ * descent with its splits. Only an empty tree can be built this way; for a
+ * non-empty tree every entry goes through the regular Insert path.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::BulkLoad(std::vector<MappingType> entries, Transaction *transaction) {
+  std::sort(entries.begin(), entries.end(),
+            [this](const MappingType &a, const MappingType &b) { return comparator_(a.first, b.first) < 0; });
+  // unique key constraint: keep the first occurrence, as Insert would
+  auto tail = std::unique(entries.begin(), entries.end(), [this](const MappingType &a, const MappingType &b) {
+    return comparator_(a.first, b.first) == 0;
+  });
+  entries.erase(tail, entries.end());
+  if (entries.empty()) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> root_guard(root_latch_);
+  if (root_page_id_ != INVALID_PAGE_ID) {
+    // Bottom-up construction cannot graft onto an existing tree.
+    root_guard.unlock();
+    for (const auto &entry : entries) {
+      Insert(entry.first, entry.second, transaction);
+    }
+    return;
+  }
+
+  // Fill nodes to a fraction of the split threshold so the first trickle of
+  // inserts after the load does not split every node it touches.
+  constexpr double kFillFactor = 0.69;
+  int capacity = std::max(1, leaf_max_size_ - 1);
+  int min_size = std::clamp(leaf_max_size_ / 2, 1, capacity);
+  int target = std::clamp(static_cast<int>(capacity * kFillFactor), min_size, capacity);
+
+  // (first key of subtree, page id) for every node of the level being built
+  std::vector<std::pair<KeyType, page_id_t>> level;
+  Page *prev_page = nullptr;
+  size_t pos = 0;
+  while (pos < entries.size()) {
+    int left = static_cast<int>(entries.size() - pos);
+    int n = std::min(target, left);
+    if (left - n > 0 && left - n < min_size) {
+      // Rebalance the tail so the last node is not left under-full.
+      n = left <= capacity ? left : (left + 1) / 2;
+    }
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while bulk loading");
+    }
+    auto *leaf = AsTreePage<LeafPage>(page);
+    leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+    leaf->CopyNFrom(entries.data() + pos, n);
+    level.emplace_back(entries[pos].first, page_id);
+    if (prev_page != nullptr) {
+      AsTreePage<LeafPage>(prev_page)->SetNextPageId(page_id);
+      buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+    }
+    prev_page = page;
+    pos += n;
+  }
+  buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+
+  capacity = std::max(2, internal_max_size_ - 1);
+  min_size = std::clamp(internal_max_size_ / 2, 2, capacity);
+  target = std::clamp(static_cast<int>(capacity * kFillFactor), min_size, capacity);
+  while (level.size() > 1) {
+    std::vector<std::pair<KeyType, page_id_t>> parents;
+    pos = 0;
+    while (pos < level.size()) {
+      int left = static_cast<int>(level.size() - pos);
+      int n = std::min(target, left);
+      if (left - n > 0 && left - n < min_size) {
+        n = left <= capacity ? left : (left + 1) / 2;
+      }
+      page_id_t page_id;
+      Page *page = buffer_pool_manager_->NewPage(&page_id);
+      if (page == nullptr) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while bulk loading");
+      }
+      auto *node = AsTreePage<InternalPage>(page);
+      node->Init(page_id, INVALID_PAGE_ID, internal_max_size_);
+      // CopyNFrom re-parents the adopted children; the first key lands in
+      // slot 0, which holds the invalid key and is never read.
+      node->CopyNFrom(level.data() + pos, n, buffer_pool_manager_);
+      parents.emplace_back(level[pos].first, page_id);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      pos += n;
+    }
+    level.swap(parents);
+  }
+
+  root_page_id_ = level.front().second;
+  UpdateRootPageId(1);
+  root_guard.unlock();
+  FlushRootPageId();
+}
 
 /*****************************************************************************
  * REMOVE
@@ -116,7 +352,31 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
  * necessary.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
+void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  // Same per-thread scratch transaction as Insert: the page-set containers
+  // are allocated once per thread instead of once per call.
+  if (transaction == nullptr) {
+    static thread_local Transaction scratch_txn(INVALID_TXN_ID);
+    transaction = &scratch_txn;
+  }
+  Page *leaf_page = FindLeafPageByOperation(key, false, Operation::DELETE, transaction);
+  if (leaf_page == nullptr) {
+    // empty tree; the descent left root_latch_ held through its sentinel
+    ReleaseAllLatches(transaction, false);
+    return;
+  }
+  auto *leaf = AsTreePage<LeafPage>(leaf_page);
+  int old_size = leaf->GetSize();
+  if (leaf->RemoveAndDeleteRecord(key, comparator_) == old_size) {
+    ReleaseAllLatches(transaction, false);
+    return;
+  }
+  if (leaf->GetSize() < leaf->GetMinSize()) {
+    CoalesceOrRedistribute(leaf, transaction);
+  }
+  ReleaseAllLatches(transaction, true);
+  FlushRootPageId();
+}
 
 /*
  * User needs to first find the sibling of input page. If sibling's size + input
@@ -128,27 +388,96 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 bool BPLUSTREE_TYPE::CoalesceOrRedistribute(N *node, Transaction *transaction) {
-  return false;
+  // Resolve this node, then walk any propagated underflow up the tree in a
+  // loop rather than recursing: every ancestor a merge can reach is still
+  // write-latched and pinned on the descent path, so each level is a plain
+  // lookup in the transaction page set instead of a new stack frame.
+  InternalPage *underflow = nullptr;
+  bool node_deleted = ResolveUnderflow(node, transaction, &underflow);
+  while (underflow != nullptr) {
+    InternalPage *next = nullptr;
+    ResolveUnderflow(underflow, transaction, &next);
+    underflow = next;
+  }
+  return node_deleted;
+}
+
+/*
+ * Handle underflow at a single level: redistribute from or merge with a
+ * sibling, or shrink the root. A merge removes a separator from the parent;
+ * if that in turn leaves the parent under min size, the parent is handed
+ * back through next_underflow for the caller's walk up the tree.
+ * @return: true means the input node was emptied and scheduled for deletion
+ */
+INDEX_TEMPLATE_ARGUMENTS
+template <typename N>
+bool BPLUSTREE_TYPE::ResolveUnderflow(N *node, Transaction *transaction, InternalPage **next_underflow) {
+  *next_underflow = nullptr;
+  if (node->IsRootPage()) {
+    bool root_deleted = AdjustRoot(node);
+    if (root_deleted) {
+      transaction->AddIntoDeletedPageSet(node->GetPageId());
+    }
+    return root_deleted;
+  }
+  // An underflowing node was never safe, so its parent is still write-latched
+  // and pinned on the descent path; reuse it instead of re-fetching.
+  Page *parent_page = PageInPath(transaction, node->GetParentPageId());
+  auto *parent = AsTreePage<InternalPage>(parent_page);
+  int index = parent->ValueIndex(node->GetPageId());
+  int sibling_index = index == 0 ? 1 : index - 1;
+  Page *sibling_page = buffer_pool_manager_->FetchPage(parent->ValueAt(sibling_index));
+  if (sibling_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while fetching sibling");
+  }
+  sibling_page->WLatch();
+  N *sibling = AsTreePage<N>(sibling_page);
+  bool node_deleted;
+  if (sibling->GetSize() + node->GetSize() >= node->GetMaxSize()) {
+    Redistribute(sibling, node, parent, index);
+    node_deleted = false;
+  } else {
+    if (Coalesce(&sibling, &node, &parent, index, transaction)) {
+      *next_underflow = parent;
+    }
+    node_deleted = true;
+  }
+  sibling_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(sibling_page->GetPageId(), true);
+  return node_deleted;
 }
 
 /*
  * Move all the key & value pairs from one page to its sibling page, and notify
  * buffer pool manager to delete this page. Parent page must be adjusted to
- * take info of deletion into account. Remember to deal with coalesce or
- * redistribute recursively if necessary.
+ * take info of deletion into account; whether that underflow needs handling
+ * is reported back so the caller can continue its iterative walk up.
  * Using template N to represent either internal page or leaf page.
  * @param   neighbor_node      sibling page of input "node"
  * @param   node               input from method coalesceOrRedistribute()
  * @param   parent             parent page of input "node"
- * @return  true means parent node should be deleted, false means no deletion
- * happend
+ * @return  true means the parent dropped below min size and still needs
+ * coalescing or redistribution of its own
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
                               BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> **parent, int index,
                               Transaction *transaction) {
-  return false;
+  // Normalize so that *node is the right sibling merged into *neighbor_node.
+  int key_index = index;
+  if (index == 0) {
+    std::swap(*neighbor_node, *node);
+    key_index = 1;
+  }
+  if constexpr (std::is_same_v<N, LeafPage>) {
+    (*node)->MoveAllTo(*neighbor_node);
+  } else {
+    (*node)->MoveAllTo(*neighbor_node, (*parent)->KeyAt(key_index), buffer_pool_manager_);
+  }
+  transaction->AddIntoDeletedPageSet((*node)->GetPageId());
+  (*parent)->Remove(key_index);
+  return (*parent)->GetSize() < (*parent)->GetMinSize();
 }
 
 /*
@@ -162,7 +491,28 @@ bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
-void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
+void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node,
+                                  BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> *parent, int index) {
+  if (index == 0) {
+    // neighbor is the right sibling: move its first pair to node's end
+    if constexpr (std::is_same_v<N, LeafPage>) {
+      neighbor_node->MoveFirstToEndOf(node);
+    } else {
+      neighbor_node->MoveFirstToEndOf(node, parent->KeyAt(1), buffer_pool_manager_);
+    }
+    parent->SetKeyAt(1, neighbor_node->KeyAt(0));
+  } else {
+    // neighbor is the left sibling: move its last pair to node's front
+    if constexpr (std::is_same_v<N, LeafPage>) {
+      neighbor_node->MoveLastToFrontOf(node);
+      parent->SetKeyAt(index, node->KeyAt(0));
+    } else {
+      KeyType separator = neighbor_node->KeyAt(neighbor_node->GetSize() - 1);
+      neighbor_node->MoveLastToFrontOf(node, parent->KeyAt(index), buffer_pool_manager_);
+      parent->SetKeyAt(index, separator);
+    }
+  }
+}
 /*
  * Update root page if necessary
  * NOTE: size of root page can be less than min size and this method is only
@@ -174,7 +524,29 @@ void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
  * happend
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
+bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) {
+  // case 1: the root lost its last separator key but still has one child,
+  // which becomes the new root
+  if (!old_root_node->IsLeafPage() && old_root_node->GetSize() == 1) {
+    auto *old_root = reinterpret_cast<InternalPage *>(old_root_node);
+    page_id_t child_page_id = old_root->RemoveAndReturnOnlyChild();
+    Page *child_page = buffer_pool_manager_->FetchPage(child_page_id);
+    auto *child = AsTreePage<BPlusTreePage>(child_page);
+    child->SetParentPageId(INVALID_PAGE_ID);
+    buffer_pool_manager_->UnpinPage(child_page_id, true);
+    // The root was not a safe page, so the descent still holds root_latch_.
+    root_page_id_ = child_page_id;
+    UpdateRootPageId(0);
+    return true;
+  }
+  // case 2: the last key of the whole tree was deleted
+  if (old_root_node->IsLeafPage() && old_root_node->GetSize() == 0) {
+    root_page_id_ = INVALID_PAGE_ID;
+    UpdateRootPageId(0);
+    return true;
+  }
+  return false;
+}
 
 /*****************************************************************************
  * INDEX ITERATOR
@@ -185,7 +557,15 @@ bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::begin() { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::begin() {
+  KeyType unused{};
+  Page *page = FindLeafPageByOperation(unused, true, Operation::READ, nullptr);
+  if (page == nullptr) {
+    return end();
+  }
+  page->RUnlatch();
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, page, 0);
+}
 
 /*
  * Input parameter is low key, find the leaf page that contains the input key
@@ -193,11 +573,35 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::begin() { return INDEXITERATOR_TYPE(); }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) {
+  Page *page = FindLeafPageByOperation(key, false, Operation::READ, nullptr);
+  if (page == nullptr) {
+    return end();
+  }
+  auto *leaf = AsTreePage<LeafPage>(page);
+  // Read everything the boundary decision needs before dropping the latch;
+  // after RUnlatch a concurrent writer may reshape the leaf.
+  int index = leaf->KeyIndex(key, comparator_);
+  int size = leaf->GetSize();
+  page_id_t next_page_id = leaf->GetNextPageId();
+  page->RUnlatch();
+  if (index >= size) {
+    // key is past this leaf's last entry; start at the next leaf's first entry
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    if (next_page_id == INVALID_PAGE_ID) {
+      return end();
+    }
+    page = buffer_pool_manager_->FetchPage(next_page_id);
+    index = 0;
+  }
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, page, index);
+}
 
 /*
  * Input parameter is void, construct an index iterator representing the end
  * of the key/value pair in the leaf node
+ * The sentinel is O(1): iterators that run off the last leaf collapse into
+ * the same state, so no traversal to the rightmost leaf is needed.
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
@@ -212,7 +616,172 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::end() { return INDEXITERATOR_TYPE(); }
  */
 INDEX_TEMPLATE_ARGUMENTS
 Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
-  throw Exception(ExceptionType::NOT_IMPLEMENTED, "Implement this for test");
+  if (IsEmpty()) {
+    return nullptr;
+  }
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  auto *node = AsTreePage<BPlusTreePage>(page);
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_page_id = leftMost ? internal->ValueAt(0) : internal->Lookup(key, comparator_);
+    Page *child_page = buffer_pool_manager_->FetchPage(child_page_id);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = child_page;
+    node = AsTreePage<BPlusTreePage>(page);
+  }
+  return page;
+}
+
+/*
+ * Find the leaf page containing particular key while obeying the latching
+ * protocol for the given operation:
+ * READ     locate the root optimistically (no root_latch_), then latch-crab
+ *          with read latches, releasing each parent as soon as the child is
+ *          latched; returns the leaf read-latched.
+ * INSERT/  latch-crab with write latches; ancestors that cannot be affected
+ * DELETE   by a split/merge below them are released early. Every page still
+ *          held (plus a nullptr sentinel for root_latch_) is recorded in the
+ *          transaction page set and released by ReleaseAllLatches().
+ * @return the latched and pinned leaf page, or nullptr if the tree is empty.
+ * On the nullptr case write descents keep root_latch_ held through the
+ * sentinel; the caller must finish with ReleaseAllLatches().
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageByOperation(const KeyType &key, bool left_most, Operation op,
+                                              Transaction *transaction) {
+  if (op == Operation::READ) {
+    // Read descents start lock-free: load the root id, pin and read-latch
+    // that page, then confirm the id is still the root. Every root change
+    // happens under a write latch on the outgoing root page, which cannot be
+    // acquired while this read latch is held, so a successful re-check means
+    // the descent starts from a stable root. The buffer pool pin taken by
+    // FetchPage keeps the frame alive between load and latch, which is the
+    // reclamation guarantee a hazard pointer would otherwise provide.
+    Page *page;
+    while (true) {
+      page_id_t root_id = root_page_id_;
+      if (root_id == INVALID_PAGE_ID) {
+        return nullptr;
+      }
+      page = buffer_pool_manager_->FetchPage(root_id);
+      if (page == nullptr) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while descending tree");
+      }
+      page->RLatch();
+      if (root_page_id_ == root_id) {
+        break;
+      }
+      // Lost a race with a root change between the load and the latch.
+      page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(root_id, false);
+    }
+    auto *node = AsTreePage<BPlusTreePage>(page);
+    while (!node->IsLeafPage()) {
+      auto *internal = reinterpret_cast<InternalPage *>(node);
+      page_id_t child_page_id = left_most ? internal->ValueAt(0) : internal->Lookup(key, comparator_);
+      Page *child_page = buffer_pool_manager_->FetchPage(child_page_id);
+      if (child_page == nullptr) {
+        page->RUnlatch();
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while descending tree");
+      }
+      child_page->RLatch();
+      page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      page = child_page;
+      node = AsTreePage<BPlusTreePage>(page);
+    }
+    return page;
+  }
+  root_latch_.lock();
+  transaction->AddIntoPageSet(nullptr);  // sentinel: root_latch_ is held
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    // Return with root_latch_ still held (the sentinel stays in the page
+    // set): what an empty tree means is the caller's call — Insert starts a
+    // new tree under the latch, Remove just releases — and holding on keeps
+    // any other writer from changing the root in between.
+    return nullptr;
+  }
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  if (page == nullptr) {
+    ReleaseAllLatches(transaction, false);
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while descending tree");
+  }
+  page->WLatch();
+  auto *node = AsTreePage<BPlusTreePage>(page);
+  while (true) {
+    if (IsSafePage(node, op)) {
+      ReleaseAllLatches(transaction, false);
+    }
+    transaction->AddIntoPageSet(page);
+    if (node->IsLeafPage()) {
+      break;
+    }
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_page_id = left_most ? internal->ValueAt(0) : internal->Lookup(key, comparator_);
+    page = buffer_pool_manager_->FetchPage(child_page_id);
+    if (page == nullptr) {
+      ReleaseAllLatches(transaction, false);
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "out of memory while descending tree");
+    }
+    page->WLatch();
+    node = AsTreePage<BPlusTreePage>(page);
+  }
+  return page;
+}
+
+/*
+ * Return the already-latched and pinned page for the given page id from the
+ * descent path recorded in the transaction page set. The caller must not
+ * unpin the result; ReleaseAllLatches() owns it. Only valid for pages the
+ * latching protocol is guaranteed to have retained (ancestors of an unsafe
+ * child), which is exactly when structure changes propagate upward.
+ */
+Page *BPlusTreeBase::PageInPath(Transaction *transaction, page_id_t page_id) const {
+  auto page_set = transaction->GetPageSet();
+  for (auto it = page_set->rbegin(); it != page_set->rend(); ++it) {
+    if (*it != nullptr && (*it)->GetPageId() == page_id) {
+      return *it;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ * A page is safe if the operation about to be applied below it cannot
+ * propagate a structure change (split or coalesce) up to it, in which case
+ * all latches above it may be released early.
+ */
+bool BPlusTreeBase::IsSafePage(BPlusTreePage *node, Operation op) const {
+  if (op == Operation::INSERT) {
+    return node->GetSize() + 1 < node->GetMaxSize();
+  }
+  // DELETE
+  if (node->IsRootPage()) {
+    return node->IsLeafPage() ? node->GetSize() > 1 : node->GetSize() > 2;
+  }
+  return node->GetSize() > node->GetMinSize();
+}
+
+/*
+ * Release every latch recorded in the transaction: unlatch and unpin the
+ * pages in the page set (a nullptr entry stands for root_latch_), then drop
+ * the pages queued for deletion now that their latches are gone.
+ */
+void BPlusTreeBase::ReleaseAllLatches(Transaction *transaction, bool dirty) {
+  for (Page *page : *transaction->GetPageSet()) {
+    if (page == nullptr) {
+      root_latch_.unlock();
+    } else {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), dirty);
+    }
+  }
+  transaction->GetPageSet()->clear();
+  for (page_id_t page_id : *transaction->GetDeletedPageSet()) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  transaction->GetDeletedPageSet()->clear();
 }
 
 /*
@@ -223,10 +792,37 @@ Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
  * insert a record <index_name, root_page_id> into header page instead of
  * updating it.
  */
-INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
-  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
+void BPlusTreeBase::UpdateRootPageId(int insert_record) {
+  // root_page_id_ stays authoritative in memory; just note that the header
+  // page is stale. Callers run inside latched critical sections, so the
+  // actual header write is deferred to FlushRootPageId().
   if (insert_record != 0) {
+    root_id_pending_insert_ = true;
+  }
+  root_id_dirty_ = true;
+}
+
+/*
+ * Write the cached root page id back to the header page. Called at the tail
+ * of every mutating operation, after all latches have been dropped, so a
+ * cascade of root changes within one operation costs a single header write
+ * and the header-page fetch never extends a critical section.
+ */
+void BPlusTreeBase::FlushRootPageId() {
+  if (!root_id_dirty_) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(header_latch_);
+  // Claim the flags before reading root_page_id_. Clearing them after the
+  // write instead would wipe out a concurrent operation's re-dirty and leave
+  // its newer root id unflushed; claimed up front, that re-dirty survives
+  // and the concurrent operation's own flush picks it up.
+  if (!root_id_dirty_.exchange(false)) {
+    return;
+  }
+  bool pending_insert = root_id_pending_insert_.exchange(false);
+  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
+  if (pending_insert) {
     // create a new record<index_name + root_page_id> in header_page
     header_page->InsertRecord(index_name_, root_page_id_);
   } else {
@@ -244,13 +840,23 @@ INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertFromFile(const std::string &file_name, Transaction *transaction) {
   int64_t key;
   std::ifstream input(file_name);
+  std::vector<MappingType> entries;
   while (input) {
     input >> key;
 
     KeyType index_key;
     index_key.SetFromInteger(key);
     RID rid(key);
-    Insert(index_key, rid, transaction);
+    entries.emplace_back(index_key, rid);
+  }
+  // An empty tree gets the bottom-up bulk load; BulkLoad itself degrades to
+  // per-key Insert if the tree has grown keys in the meantime.
+  if (IsEmpty()) {
+    BulkLoad(std::move(entries), transaction);
+    return;
+  }
+  for (const auto &entry : entries) {
+    Insert(entry.first, entry.second, transaction);
   }
 }
 /*
@@ -12,19 +12,51 @@ namespace bustub {
  * set your own input parameters
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::IndexIterator() = default;
+INDEXITERATOR_TYPE::IndexIterator() : buffer_pool_manager_(nullptr), page_(nullptr), index_(0) {}
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::~IndexIterator() = default;
+INDEXITERATOR_TYPE::IndexIterator(BufferPoolManager *buffer_pool_manager, Page *page, int index)
+    : buffer_pool_manager_(buffer_pool_manager), page_(page), index_(index) {}
 
 INDEX_TEMPLATE_ARGUMENTS
-bool INDEXITERATOR_TYPE::isEnd() { throw std::runtime_error("unimplemented"); }
+INDEXITERATOR_TYPE::~IndexIterator() {
+  if (page_ != nullptr) {
+    buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+  }
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-const MappingType &INDEXITERATOR_TYPE::operator*() { throw std::runtime_error("unimplemented"); }
+bool INDEXITERATOR_TYPE::isEnd() { return page_ == nullptr; }
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() { throw std::runtime_error("unimplemented"); }
+const MappingType &INDEXITERATOR_TYPE::operator*() {
+  auto *leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+  return leaf->GetItem(index_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
+  auto *leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+  index_++;
+  if (index_ >= leaf->GetSize()) {
+    page_id_t next_page_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+    if (next_page_id == INVALID_PAGE_ID) {
+      // walked off the last leaf: collapse into the end sentinel
+      page_ = nullptr;
+    } else {
+      page_ = buffer_pool_manager_->FetchPage(next_page_id);
+      auto *next_leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+      // Stay one leaf ahead of the scan: warm this leaf's header now and ask
+      // the buffer pool to warm the sibling's frame, so the next boundary
+      // crossing finds its cache lines already in flight.
+      __builtin_prefetch(next_leaf);
+      buffer_pool_manager_->PrefetchPage(next_leaf->GetNextPageId());
+    }
+    index_ = 0;
+  }
+  return *this;
+}
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_manager_set_test.cpp
+//
+// Identification: test/buffer/buffer_pool_manager_set_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/buffer_pool_manager_set.h"
+#include <cstdio>
+#include <string>
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerSetTest, SampleTest) {
+  const std::string db_name = "test.db";
+  const size_t num_instances = 4;
+  const size_t pool_size = 5;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm_set = new BufferPoolManagerSet(num_instances, pool_size, disk_manager);
+
+  EXPECT_EQ(num_instances * pool_size, bpm_set->GetPoolSize());
+
+  // Scenario: fill every instance. Sequential ids shard round-robin, so all
+  // num_instances * pool_size pages fit while pinned.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    Page *page = bpm_set->NewPage(&page_id_temp);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(static_cast<page_id_t>(i), page_id_temp);
+    snprintf(page->GetData(), PAGE_SIZE, "Hello%d", page_id_temp);
+  }
+
+  // Scenario: every frame of the next id's owning instance is pinned, so a
+  // further page cannot be created.
+  EXPECT_EQ(nullptr, bpm_set->NewPage(&page_id_temp));
+
+  // Scenario: unpinning routes to the owning instance and frees its frames.
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    EXPECT_EQ(true, bpm_set->UnpinPage(static_cast<page_id_t>(i), true));
+  }
+
+  // Scenario: evict the first pages by creating new ones, then fetch them
+  // back and check their contents survived the round trip through disk.
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm_set->NewPage(&page_id_temp));
+    bpm_set->UnpinPage(page_id_temp, false);
+  }
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    Page *page = bpm_set->FetchPage(static_cast<page_id_t>(i));
+    ASSERT_NE(nullptr, page);
+    char expected[PAGE_SIZE];
+    snprintf(expected, PAGE_SIZE, "Hello%d", static_cast<page_id_t>(i));
+    EXPECT_EQ(0, strcmp(page->GetData(), expected));
+    EXPECT_EQ(true, bpm_set->UnpinPage(static_cast<page_id_t>(i), false));
+  }
+
+  // Scenario: deleting routes to the owning instance as well.
+  EXPECT_EQ(true, bpm_set->DeletePage(0));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete bpm_set;
+  delete disk_manager;
+}
+
+}  // namespace bustub